@@ -2,6 +2,8 @@
 #define TECS_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,7 +39,11 @@ typedef enum tECS_result_t {
 	TECS_RESULT_NO_ENTITIES_AVAILABLE,
 	TECS_RESULT_INVALID_ENTITY_ID,
 	TECS_RESULT_ENTITY_ALREADY_FREE,
-	TECS_RESULT_COMPONENT_TABLE_ROW_REMOVE_OUT_OF_BOUNDS
+	TECS_RESULT_COMPONENT_TABLE_ROW_REMOVE_OUT_OF_BOUNDS,
+	TECS_RESULT_DELTA_STREAM_END,
+	TECS_RESULT_DELTA_STREAM_IO_ERROR,
+	TECS_RESULT_DELTA_STREAM_MALFORMED,
+	TECS_RESULT_DELTA_ARCHETYPE_NOT_FOUND
 } tECS_result_t;
 
 // A component index is an unsigned integer type used for indexing component-types.
@@ -96,6 +102,87 @@ typedef struct record_t {
 // A system is a function that can be executed on all rows of components in an archetype.
 typedef void (*system_t)(archetype_t *archetype_ptr, size_t row, void *data_ptr);
 
+// The structures below are the Apache Arrow C Data Interface, copied verbatim from the Arrow specification.
+// The include guard is the one mandated by the specification, so that this header can coexist with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	// Array type description
+	const char *format;
+	const char *name;
+	const char *metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema **children;
+	struct ArrowSchema *dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowSchema *);
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+struct ArrowArray {
+	// Array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void **buffers;
+	struct ArrowArray **children;
+	struct ArrowArray *dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowArray *);
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+#endif	// ARROW_C_DATA_INTERFACE
+
+// A delta encoder remembers the state of every entity as of the last encoded tick, its baseline.
+// Each tick it writes only what changed since the baseline to a stream, then advances the baseline.
+typedef struct delta_encoder_t {
+
+	// Whether each entity was alive in the baseline. Indexed by entity.
+	unsigned char *m_baseline_alive;
+
+	// Component mask of each entity in the baseline. Indexed by entity.
+	component_mask_t *m_baseline_masks;
+
+	// Component bytes of each entity in the baseline, packed in component index order. Indexed by entity.
+	unsigned char **m_baseline_components;
+
+} delta_encoder_t;
+
+// Resolves a component mask to the local archetype in which entities with that signature are to be created.
+// Returns null if there is no such archetype.
+typedef archetype_t *(*delta_archetype_resolver_t)(component_mask_t component_mask, void *data_ptr);
+
+// A delta decoder applies a stream written by a delta encoder to the local entity manager.
+// Entities are created locally with whatever handle the entity manager provides, so the decoder maps the encoder's entities to local ones.
+typedef struct delta_decoder_t {
+
+	// Resolves component masks read from the stream to local archetypes.
+	delta_archetype_resolver_t m_resolver;
+
+	// Passed to the resolver on every call.
+	void *m_resolver_data_ptr;
+
+	// Whether each of the encoder's entities is currently mapped to a local entity. Indexed by the encoder's entity.
+	unsigned char *m_remote_alive;
+
+	// Maps the encoder's entities to local entities. Indexed by the encoder's entity.
+	entity_t *m_remote_to_local;
+
+} delta_decoder_t;
+
 
 
 /* -- FUNCTION DECLARATIONS -- */
@@ -151,6 +238,16 @@ tECS_result_t archetype_remove_row(archetype_t *archetype_ptr, size_t row);
 // Deletes the archetype, freeing all pointers.
 void free_archetype(archetype_t archetype);
 
+/*	Export Functions */
+
+// Exports the archetype's component table as an Arrow struct array, without copying any component data.
+// The first child, named "entity", is the archetype's row-to-entity map; every other child, named "component_<index>", is a fixed-size binary column of the component-type with that index.
+// Each child's data buffer points directly into the archetype, so the exported arrays are only valid until a row is next added to or removed from the archetype.
+// The caller must call the release callbacks of *schema_ptr and *array_ptr once done; this frees only the export's bookkeeping, never the archetype's data.
+// If parameter archetype_ptr, schema_ptr, or array_ptr is null, then this function does nothing and silently returns TECS_RESULT_SUCCESS.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails, in which case neither *schema_ptr nor *array_ptr is touched.
+tECS_result_t archetype_export_arrow(archetype_t *archetype_ptr, struct ArrowSchema *schema_ptr, struct ArrowArray *array_ptr);
+
 /*	Entitiy Functions */
 
 // Initializes the entity manager, preparing the pool of available entities.
@@ -177,6 +274,41 @@ tECS_result_t free_entity(entity_t entity);
 // Executes the system on the archetype.
 void execute_system(archetype_t *archetype_ptr, system_t system, void *data_ptr);
 
+/*	Delta Functions */
+
+// Creates a new delta encoder with an empty baseline, so that the first tick encodes every living entity as created.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails.
+tECS_result_t create_delta_encoder(delta_encoder_t *encoder_ptr);
+
+// Writes one tick to the stream: destroyed entities, then created entities, archetype migrations and changed component bytes, all relative to the baseline.
+// On success, the baseline then matches the current state.
+// An entity that was freed and whose handle was reused within the same tick is encoded as a migration or an update of that handle.
+// Returns TECS_RESULT_DELTA_STREAM_IO_ERROR if writing to the stream fails.
+// Returns TECS_RESULT_BAD_ALLOC if the baseline cannot be grown.
+// The baseline is advanced as each operation is encoded, so after any result other than TECS_RESULT_SUCCESS the baseline may hold changes the stream never received, and part of the tick may already have been written.
+// Retrying is therefore not possible: the encoder and the stream must both be recreated, and the decoder must start over from a fresh world.
+tECS_result_t delta_encode_tick(delta_encoder_t *encoder_ptr, FILE *stream);
+
+// Destroys the delta encoder, freeing its baseline.
+void free_delta_encoder(delta_encoder_t encoder);
+
+// Creates a new delta decoder that resolves archetypes with the given resolver.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails.
+tECS_result_t create_delta_decoder(delta_archetype_resolver_t resolver, void *resolver_data_ptr, delta_decoder_t *decoder_ptr);
+
+// Reads one tick from the stream and applies it to the local entity manager.
+// Returns TECS_RESULT_DELTA_STREAM_END if the stream ended cleanly before the tick.
+// Returns TECS_RESULT_DELTA_STREAM_IO_ERROR if reading from the stream fails or it ends mid-tick.
+// Returns TECS_RESULT_DELTA_STREAM_MALFORMED if the tick does not match the local component registry or entity state.
+// Returns TECS_RESULT_DELTA_ARCHETYPE_NOT_FOUND if the resolver returns null.
+// Any error from create_entity or free_entity is returned as-is.
+// Operations are applied as they are read, so after any result other than TECS_RESULT_SUCCESS or TECS_RESULT_DELTA_STREAM_END the tick is partly applied: entities may already have been created or freed, and a migrating entity may have been freed without being recreated.
+// The local world is then inconsistent with the encoder, and must be discarded along with the decoder.
+tECS_result_t delta_decode_tick(delta_decoder_t *decoder_ptr, FILE *stream);
+
+// Destroys the delta decoder. Local entities created by the decoder are not freed.
+void free_delta_decoder(delta_decoder_t decoder);
+
 #ifdef __cplusplus
 }
 #endif
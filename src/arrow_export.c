@@ -0,0 +1,213 @@
+#include "arrow_export.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bookkeeping owned by an exported schema.
+// Every schema, parent or child, owns its own bookkeeping so that a consumer may move a child out of its parent, as permitted by the Arrow specification.
+typedef struct arrow_schema_private_t {
+
+	// Backing storage of the schema's format string.
+	char m_format[32];
+
+	// Backing storage of the schema's name.
+	char m_name[32];
+
+	// Storage of the child schemas, and the pointer-array handed to the consumer. Both are null if the schema has no children.
+	struct ArrowSchema *m_children;
+	struct ArrowSchema **m_child_ptrs;
+
+} arrow_schema_private_t;
+
+// Bookkeeping owned by an exported array.
+typedef struct arrow_array_private_t {
+
+	// The array's buffers: the validity buffer, which is always null, followed by the data buffer, if any.
+	const void *m_buffers[2];
+
+	// Storage of the child arrays, and the pointer-array handed to the consumer. Both are null if the array has no children.
+	struct ArrowArray *m_children;
+	struct ArrowArray **m_child_ptrs;
+
+} arrow_array_private_t;
+
+static void release_arrow_schema(struct ArrowSchema *schema_ptr) {
+	arrow_schema_private_t *private_ptr = schema_ptr->private_data;
+
+	// Children that were moved out by the consumer have already had their release callback nulled, and are skipped.
+	for (int64_t i = 0; i < schema_ptr->n_children; ++i) {
+		if (schema_ptr->children[i]->release)
+			schema_ptr->children[i]->release(schema_ptr->children[i]);
+	}
+
+	free(private_ptr->m_children);
+	free(private_ptr->m_child_ptrs);
+	free(private_ptr);
+	schema_ptr->release = NULL;
+}
+
+static void release_arrow_array(struct ArrowArray *array_ptr) {
+	arrow_array_private_t *private_ptr = array_ptr->private_data;
+
+	for (int64_t i = 0; i < array_ptr->n_children; ++i) {
+		if (array_ptr->children[i]->release)
+			array_ptr->children[i]->release(array_ptr->children[i]);
+	}
+
+	free(private_ptr->m_children);
+	free(private_ptr->m_child_ptrs);
+	free(private_ptr);
+	array_ptr->release = NULL;
+}
+
+// Initializes *schema_ptr with the given format and name, and allocates (but does not initialize) its children.
+// Each child's release callback is nulled, so that the schema may be safely released before all of its children are initialized.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails, in which case nothing is left allocated.
+static tECS_result_t init_arrow_schema(struct ArrowSchema *schema_ptr, const char *format, const char *name, int64_t n_children) {
+
+	arrow_schema_private_t *private_ptr = calloc(1, sizeof(arrow_schema_private_t));
+	if (!private_ptr)
+		return TECS_RESULT_BAD_ALLOC;
+
+	if (n_children > 0) {
+		private_ptr->m_children = calloc(n_children, sizeof(struct ArrowSchema));
+		private_ptr->m_child_ptrs = calloc(n_children, sizeof(struct ArrowSchema *));
+		if (!private_ptr->m_children || !private_ptr->m_child_ptrs) {
+			free(private_ptr->m_children);
+			free(private_ptr->m_child_ptrs);
+			free(private_ptr);
+			return TECS_RESULT_BAD_ALLOC;
+		}
+		for (int64_t i = 0; i < n_children; ++i) {
+			private_ptr->m_child_ptrs[i] = private_ptr->m_children + i;
+		}
+	}
+
+	strncpy(private_ptr->m_format, format, sizeof private_ptr->m_format - 1);
+	if (name)
+		strncpy(private_ptr->m_name, name, sizeof private_ptr->m_name - 1);
+
+	schema_ptr->format = private_ptr->m_format;
+	schema_ptr->name = name ? private_ptr->m_name : NULL;
+	schema_ptr->metadata = NULL;
+	schema_ptr->flags = 0;
+	schema_ptr->n_children = n_children;
+	schema_ptr->children = private_ptr->m_child_ptrs;
+	schema_ptr->dictionary = NULL;
+	schema_ptr->release = release_arrow_schema;
+	schema_ptr->private_data = private_ptr;
+
+	return TECS_RESULT_SUCCESS;
+}
+
+// Initializes *array_ptr with the given length and buffers, and allocates (but does not initialize) its children.
+// If parameter has_data_buffer is zero, then the array has only a validity buffer; otherwise it also has parameter data_ptr as its data buffer.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails, in which case nothing is left allocated.
+static tECS_result_t init_arrow_array(struct ArrowArray *array_ptr, size_t length, int has_data_buffer, const void *data_ptr, int64_t n_children) {
+
+	arrow_array_private_t *private_ptr = calloc(1, sizeof(arrow_array_private_t));
+	if (!private_ptr)
+		return TECS_RESULT_BAD_ALLOC;
+
+	if (n_children > 0) {
+		private_ptr->m_children = calloc(n_children, sizeof(struct ArrowArray));
+		private_ptr->m_child_ptrs = calloc(n_children, sizeof(struct ArrowArray *));
+		if (!private_ptr->m_children || !private_ptr->m_child_ptrs) {
+			free(private_ptr->m_children);
+			free(private_ptr->m_child_ptrs);
+			free(private_ptr);
+			return TECS_RESULT_BAD_ALLOC;
+		}
+		for (int64_t i = 0; i < n_children; ++i) {
+			private_ptr->m_child_ptrs[i] = private_ptr->m_children + i;
+		}
+	}
+
+	// No component is ever null, so the validity buffer is always omitted.
+	private_ptr->m_buffers[0] = NULL;
+	private_ptr->m_buffers[1] = data_ptr;
+
+	array_ptr->length = (int64_t)length;
+	array_ptr->null_count = 0;
+	array_ptr->offset = 0;
+	array_ptr->n_buffers = has_data_buffer ? 2 : 1;
+	array_ptr->n_children = n_children;
+	array_ptr->buffers = private_ptr->m_buffers;
+	array_ptr->children = private_ptr->m_child_ptrs;
+	array_ptr->dictionary = NULL;
+	array_ptr->release = release_arrow_array;
+	array_ptr->private_data = private_ptr;
+
+	return TECS_RESULT_SUCCESS;
+}
+
+// Writes the Arrow format string of entity_t into the buffer.
+// Entities are exported as unsigned integers when entity_t has the width of one, and as fixed-size binary otherwise.
+static void get_entity_format(char *format, size_t format_size) {
+	switch (sizeof(entity_t)) {
+		case 1: snprintf(format, format_size, "C"); break;
+		case 2: snprintf(format, format_size, "S"); break;
+		case 4: snprintf(format, format_size, "I"); break;
+		case 8: snprintf(format, format_size, "L"); break;
+		default: snprintf(format, format_size, "w:%zu", sizeof(entity_t)); break;
+	}
+}
+
+tECS_result_t archetype_export_arrow(archetype_t *archetype_ptr, struct ArrowSchema *schema_ptr, struct ArrowArray *array_ptr) {
+
+	if (!archetype_ptr || !schema_ptr || !array_ptr)
+		return TECS_RESULT_SUCCESS;
+
+	// Count the registered component-types in the archetype's signature; each gets one child after the entity child.
+	size_t num_components = 0;
+	for (size_t i = 0; i < sizeof(component_mask_t) * 8 && i < get_num_registered_components(); ++i) {
+		num_components += (archetype_ptr->m_component_mask >> i) & 1;
+	}
+	int64_t n_children = (int64_t)num_components + 1;
+
+	struct ArrowSchema schema;
+	struct ArrowArray array;
+	tECS_result_t result = init_arrow_schema(&schema, "+s", NULL, n_children);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+	result = init_arrow_array(&array, archetype_ptr->m_num_used_rows, 0, NULL, n_children);
+	if (result != TECS_RESULT_SUCCESS) {
+		schema.release(&schema);
+		return result;
+	}
+
+	// The entity child points straight at the row-to-entity map.
+	char format[32];
+	get_entity_format(format, sizeof format);
+	result = init_arrow_schema(schema.children[0], format, "entity", 0);
+	if (result == TECS_RESULT_SUCCESS)
+		result = init_arrow_array(array.children[0], archetype_ptr->m_num_used_rows, 1, archetype_ptr->m_rows_to_entities, 0);
+
+	// Each component child points straight at its column in the component table.
+	int64_t child = 1;
+	for (size_t i = 0; i < sizeof(component_mask_t) * 8 && i < get_num_registered_components() && result == TECS_RESULT_SUCCESS; ++i) {
+		if (!((archetype_ptr->m_component_mask >> i) & 1))
+			continue;
+
+		component_array_t column = archetype_get_column(archetype_ptr, i);
+		char name[32];
+		snprintf(format, sizeof format, "w:%zu", column.m_component_size);
+		snprintf(name, sizeof name, "component_%zu", i);
+		result = init_arrow_schema(schema.children[child], format, name, 0);
+		if (result == TECS_RESULT_SUCCESS)
+			result = init_arrow_array(array.children[child], archetype_ptr->m_num_used_rows, 1, column.m_components, 0);
+		child++;
+	}
+
+	if (result != TECS_RESULT_SUCCESS) {
+		schema.release(&schema);
+		array.release(&array);
+		return result;
+	}
+
+	*schema_ptr = schema;
+	*array_ptr = array;
+
+	return TECS_RESULT_SUCCESS;
+}
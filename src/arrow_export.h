@@ -0,0 +1,61 @@
+#ifndef ARROW_EXPORT_H
+#define ARROW_EXPORT_H
+
+#include <stdint.h>
+
+#include "tecs_result.h"
+#include "archetype.h"
+
+// The structures below are the Apache Arrow C Data Interface, copied verbatim from the Arrow specification.
+// The include guard is the one mandated by the specification, so that this header can coexist with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	// Array type description
+	const char *format;
+	const char *name;
+	const char *metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema **children;
+	struct ArrowSchema *dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowSchema *);
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+struct ArrowArray {
+	// Array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void **buffers;
+	struct ArrowArray **children;
+	struct ArrowArray *dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowArray *);
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+#endif	// ARROW_C_DATA_INTERFACE
+
+// Exports the archetype's component table as an Arrow struct array, without copying any component data.
+// The first child, named "entity", is the archetype's row-to-entity map; every other child, named "component_<index>", is a fixed-size binary column of the component-type with that index.
+// Each child's data buffer points directly into the archetype, so the exported arrays are only valid until a row is next added to or removed from the archetype.
+// The caller must call the release callbacks of *schema_ptr and *array_ptr once done; this frees only the export's bookkeeping, never the archetype's data.
+// If parameter archetype_ptr, schema_ptr, or array_ptr is null, then this function does nothing and silently returns TECS_RESULT_SUCCESS.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails, in which case neither *schema_ptr nor *array_ptr is touched.
+tECS_result_t archetype_export_arrow(archetype_t *archetype_ptr, struct ArrowSchema *schema_ptr, struct ArrowArray *array_ptr);
+
+#endif	// ARROW_EXPORT_H
@@ -0,0 +1,393 @@
+#include "delta.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -- STREAM FORMAT -- */
+
+// A tick is a sequence of operations terminated by DELTA_OP_END_TICK.
+// Each operation is a one-byte opcode followed by its operands. Integer operands are unsigned LEB128 varints; component bytes are written raw, so both ends must share the same component layouts.
+enum {
+	// No operands.
+	DELTA_OP_END_TICK = 0,
+
+	// Operands: entity.
+	DELTA_OP_DESTROY,
+
+	// Operands: entity, component mask, byte count, then the entity's components packed in component index order.
+	DELTA_OP_CREATE,
+
+	// Same operands as DELTA_OP_CREATE; the entity moves to the archetype of the new component mask.
+	DELTA_OP_MIGRATE,
+
+	// Operands: entity, component index, byte offset, byte count, then the changed bytes of that component.
+	DELTA_OP_UPDATE
+};
+
+/* -- STREAM HELPERS -- */
+
+static tECS_result_t write_bytes(FILE *stream, const void *bytes, size_t count) {
+	if (count > 0 && fwrite(bytes, 1, count, stream) != count)
+		return TECS_RESULT_DELTA_STREAM_IO_ERROR;
+	return TECS_RESULT_SUCCESS;
+}
+
+static tECS_result_t write_varint(FILE *stream, uintmax_t value) {
+	unsigned char bytes[(sizeof value * 8 + 6) / 7];
+	size_t count = 0;
+	do {
+		bytes[count] = value & 0x7F;
+		value >>= 7;
+		if (value)
+			bytes[count] |= 0x80;
+		count++;
+	} while (value);
+	return write_bytes(stream, bytes, count);
+}
+
+static tECS_result_t read_bytes(FILE *stream, void *bytes, size_t count) {
+	if (count > 0 && fread(bytes, 1, count, stream) != count)
+		return TECS_RESULT_DELTA_STREAM_IO_ERROR;
+	return TECS_RESULT_SUCCESS;
+}
+
+static tECS_result_t read_varint(FILE *stream, uintmax_t *value_ptr) {
+	uintmax_t value = 0;
+	for (size_t shift = 0; shift < sizeof value * 8; shift += 7) {
+		int byte = fgetc(stream);
+		if (byte == EOF)
+			return TECS_RESULT_DELTA_STREAM_IO_ERROR;
+		value |= (uintmax_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			*value_ptr = value;
+			return TECS_RESULT_SUCCESS;
+		}
+	}
+	return TECS_RESULT_DELTA_STREAM_MALFORMED;
+}
+
+/* -- COMPONENT HELPERS -- */
+
+// Returns whether the component-type with the given index is registered and set in the component mask.
+static int mask_has_component(component_mask_t component_mask, component_index_t component_index) {
+	return component_index < sizeof(component_mask_t) * 8 && component_index < get_num_registered_components() && ((component_mask >> component_index) & 1);
+}
+
+// Returns a pointer to the given entity's component of the given type within the archetype.
+static unsigned char *get_component_bytes(archetype_t *archetype_ptr, size_t row, component_index_t component_index) {
+	component_array_t column = archetype_get_column(archetype_ptr, component_index);
+	return (unsigned char *)column.m_components + (row * column.m_component_size);
+}
+
+// Returns the total size in bytes of all components of one row in the archetype.
+static size_t get_row_size(archetype_t *archetype_ptr) {
+	size_t size = 0;
+	for (component_index_t i = 0; i < get_num_registered_components(); ++i) {
+		if (mask_has_component(archetype_ptr->m_component_mask, i))
+			size += archetype_get_column(archetype_ptr, i).m_component_size;
+	}
+	return size;
+}
+
+/* -- ENCODER -- */
+
+tECS_result_t create_delta_encoder(delta_encoder_t *encoder_ptr) {
+
+	if (!encoder_ptr)
+		return TECS_RESULT_SUCCESS;
+
+	encoder_ptr->m_baseline_alive = calloc(MAX_NUM_ENTITIES, sizeof(unsigned char));
+	encoder_ptr->m_baseline_masks = calloc(MAX_NUM_ENTITIES, sizeof(component_mask_t));
+	encoder_ptr->m_baseline_components = calloc(MAX_NUM_ENTITIES, sizeof(unsigned char *));
+	if (!encoder_ptr->m_baseline_alive || !encoder_ptr->m_baseline_masks || !encoder_ptr->m_baseline_components) {
+		free_delta_encoder(*encoder_ptr);
+		return TECS_RESULT_BAD_ALLOC;
+	}
+
+	return TECS_RESULT_SUCCESS;
+}
+
+// Writes the entity in full as a creation or migration, and replaces its baseline with its current state.
+static tECS_result_t encode_entity(delta_encoder_t *encoder_ptr, FILE *stream, entity_t entity, record_t record, unsigned char opcode) {
+
+	archetype_t *archetype_ptr = record.m_archetype_ptr;
+	size_t row_size = get_row_size(archetype_ptr);
+
+	// Allocate at least one byte so that a row of empty components still has a baseline distinct from null.
+	unsigned char *baseline = realloc(encoder_ptr->m_baseline_components[entity], row_size ? row_size : 1);
+	if (!baseline)
+		return TECS_RESULT_BAD_ALLOC;
+	encoder_ptr->m_baseline_components[entity] = baseline;
+	encoder_ptr->m_baseline_alive[entity] = 1;
+	encoder_ptr->m_baseline_masks[entity] = archetype_ptr->m_component_mask;
+
+	// Pack the components into the baseline, which then doubles as the bytes to write.
+	size_t offset = 0;
+	for (component_index_t i = 0; i < get_num_registered_components(); ++i) {
+		if (!mask_has_component(archetype_ptr->m_component_mask, i))
+			continue;
+		size_t component_size = archetype_get_column(archetype_ptr, i).m_component_size;
+		memcpy(baseline + offset, get_component_bytes(archetype_ptr, record.m_row, i), component_size);
+		offset += component_size;
+	}
+
+	tECS_result_t result = write_bytes(stream, &opcode, 1);
+	if (result == TECS_RESULT_SUCCESS)
+		result = write_varint(stream, entity);
+	if (result == TECS_RESULT_SUCCESS)
+		result = write_varint(stream, archetype_ptr->m_component_mask);
+	if (result == TECS_RESULT_SUCCESS)
+		result = write_varint(stream, row_size);
+	if (result == TECS_RESULT_SUCCESS)
+		result = write_bytes(stream, baseline, row_size);
+	return result;
+}
+
+// Writes the span of bytes that changed in each of the entity's components since the baseline, and updates the baseline to match.
+static tECS_result_t encode_entity_updates(delta_encoder_t *encoder_ptr, FILE *stream, entity_t entity, record_t record) {
+
+	archetype_t *archetype_ptr = record.m_archetype_ptr;
+	unsigned char *baseline = encoder_ptr->m_baseline_components[entity];
+	for (component_index_t i = 0; i < get_num_registered_components(); ++i) {
+		if (!mask_has_component(archetype_ptr->m_component_mask, i))
+			continue;
+
+		size_t component_size = archetype_get_column(archetype_ptr, i).m_component_size;
+		const unsigned char *current = get_component_bytes(archetype_ptr, record.m_row, i);
+
+		// Only the span from the first to the last changed byte is written; bytes in between are written even if unchanged.
+		size_t first = 0;
+		while (first < component_size && current[first] == baseline[first])
+			first++;
+		if (first < component_size) {
+			size_t last = component_size - 1;
+			while (current[last] == baseline[last])
+				last--;
+			size_t count = last - first + 1;
+			memcpy(baseline + first, current + first, count);
+
+			unsigned char opcode = DELTA_OP_UPDATE;
+			tECS_result_t result = write_bytes(stream, &opcode, 1);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_varint(stream, entity);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_varint(stream, i);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_varint(stream, first);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_varint(stream, count);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_bytes(stream, current + first, count);
+			if (result != TECS_RESULT_SUCCESS)
+				return result;
+		}
+		baseline += component_size;
+	}
+
+	return TECS_RESULT_SUCCESS;
+}
+
+tECS_result_t delta_encode_tick(delta_encoder_t *encoder_ptr, FILE *stream) {
+
+	tECS_result_t result = TECS_RESULT_SUCCESS;
+
+	// Destroyed entities are written first, so that the decoder frees local entities before it needs new ones.
+	for (size_t i = 0; i < MAX_NUM_ENTITIES && result == TECS_RESULT_SUCCESS; ++i) {
+		entity_t entity = (entity_t)i;
+		if (encoder_ptr->m_baseline_alive[i] && !get_entity_record(entity).m_archetype_ptr) {
+			unsigned char opcode = DELTA_OP_DESTROY;
+			encoder_ptr->m_baseline_alive[i] = 0;
+			result = write_bytes(stream, &opcode, 1);
+			if (result == TECS_RESULT_SUCCESS)
+				result = write_varint(stream, entity);
+		}
+	}
+
+	for (size_t i = 0; i < MAX_NUM_ENTITIES && result == TECS_RESULT_SUCCESS; ++i) {
+		entity_t entity = (entity_t)i;
+		record_t record = get_entity_record(entity);
+		if (!record.m_archetype_ptr)
+			continue;
+
+		if (!encoder_ptr->m_baseline_alive[i])
+			result = encode_entity(encoder_ptr, stream, entity, record, DELTA_OP_CREATE);
+		else if (encoder_ptr->m_baseline_masks[i] != record.m_archetype_ptr->m_component_mask)
+			result = encode_entity(encoder_ptr, stream, entity, record, DELTA_OP_MIGRATE);
+		else
+			result = encode_entity_updates(encoder_ptr, stream, entity, record);
+	}
+
+	if (result == TECS_RESULT_SUCCESS) {
+		unsigned char opcode = DELTA_OP_END_TICK;
+		result = write_bytes(stream, &opcode, 1);
+	}
+	if (result == TECS_RESULT_SUCCESS && fflush(stream) != 0)
+		result = TECS_RESULT_DELTA_STREAM_IO_ERROR;
+
+	return result;
+}
+
+void free_delta_encoder(delta_encoder_t encoder) {
+
+	if (encoder.m_baseline_components) {
+		for (size_t i = 0; i < MAX_NUM_ENTITIES; ++i) {
+			free(encoder.m_baseline_components[i]);
+		}
+	}
+
+	free(encoder.m_baseline_alive);
+	free(encoder.m_baseline_masks);
+	free(encoder.m_baseline_components);
+}
+
+/* -- DECODER -- */
+
+tECS_result_t create_delta_decoder(delta_archetype_resolver_t resolver, void *resolver_data_ptr, delta_decoder_t *decoder_ptr) {
+
+	if (!decoder_ptr)
+		return TECS_RESULT_SUCCESS;
+
+	decoder_ptr->m_resolver = resolver;
+	decoder_ptr->m_resolver_data_ptr = resolver_data_ptr;
+	decoder_ptr->m_remote_alive = calloc(MAX_NUM_ENTITIES, sizeof(unsigned char));
+	decoder_ptr->m_remote_to_local = calloc(MAX_NUM_ENTITIES, sizeof(entity_t));
+	if (!decoder_ptr->m_remote_alive || !decoder_ptr->m_remote_to_local) {
+		free_delta_decoder(*decoder_ptr);
+		return TECS_RESULT_BAD_ALLOC;
+	}
+
+	return TECS_RESULT_SUCCESS;
+}
+
+// Reads an entity of the encoder from the stream, checking that it is within bounds.
+static tECS_result_t read_remote_entity(FILE *stream, size_t *remote_ptr) {
+	uintmax_t value;
+	tECS_result_t result = read_varint(stream, &value);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+	if (value >= MAX_NUM_ENTITIES)
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+	*remote_ptr = (size_t)value;
+	return TECS_RESULT_SUCCESS;
+}
+
+static tECS_result_t decode_destroy(delta_decoder_t *decoder_ptr, FILE *stream) {
+
+	size_t remote;
+	tECS_result_t result = read_remote_entity(stream, &remote);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+	if (!decoder_ptr->m_remote_alive[remote])
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	decoder_ptr->m_remote_alive[remote] = 0;
+	return free_entity(decoder_ptr->m_remote_to_local[remote]);
+}
+
+// Decodes a creation or a migration, which differ only in whether the entity must already exist.
+// A migrating entity is freed and recreated in its new archetype, so its local handle may change.
+static tECS_result_t decode_create(delta_decoder_t *decoder_ptr, FILE *stream, int is_migration) {
+
+	size_t remote;
+	uintmax_t component_mask;
+	uintmax_t row_size;
+	tECS_result_t result = read_remote_entity(stream, &remote);
+	if (result == TECS_RESULT_SUCCESS)
+		result = read_varint(stream, &component_mask);
+	if (result == TECS_RESULT_SUCCESS)
+		result = read_varint(stream, &row_size);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+
+	if (decoder_ptr->m_remote_alive[remote] != is_migration || (component_mask_t)component_mask != component_mask)
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	archetype_t *archetype_ptr = decoder_ptr->m_resolver((component_mask_t)component_mask, decoder_ptr->m_resolver_data_ptr);
+	if (!archetype_ptr)
+		return TECS_RESULT_DELTA_ARCHETYPE_NOT_FOUND;
+	if (archetype_ptr->m_component_mask != component_mask || get_row_size(archetype_ptr) != row_size)
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	if (is_migration) {
+		decoder_ptr->m_remote_alive[remote] = 0;
+		result = free_entity(decoder_ptr->m_remote_to_local[remote]);
+		if (result != TECS_RESULT_SUCCESS)
+			return result;
+	}
+
+	entity_t local;
+	result = create_entity(archetype_ptr, &local);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+	decoder_ptr->m_remote_alive[remote] = 1;
+	decoder_ptr->m_remote_to_local[remote] = local;
+
+	// Read each component straight into its column.
+	size_t row = get_entity_record(local).m_row;
+	for (component_index_t i = 0; i < get_num_registered_components() && result == TECS_RESULT_SUCCESS; ++i) {
+		if (mask_has_component(archetype_ptr->m_component_mask, i))
+			result = read_bytes(stream, get_component_bytes(archetype_ptr, row, i), archetype_get_column(archetype_ptr, i).m_component_size);
+	}
+
+	return result;
+}
+
+static tECS_result_t decode_update(delta_decoder_t *decoder_ptr, FILE *stream) {
+
+	size_t remote;
+	uintmax_t component_index;
+	uintmax_t offset;
+	uintmax_t count;
+	tECS_result_t result = read_remote_entity(stream, &remote);
+	if (result == TECS_RESULT_SUCCESS)
+		result = read_varint(stream, &component_index);
+	if (result == TECS_RESULT_SUCCESS)
+		result = read_varint(stream, &offset);
+	if (result == TECS_RESULT_SUCCESS)
+		result = read_varint(stream, &count);
+	if (result != TECS_RESULT_SUCCESS)
+		return result;
+
+	if (!decoder_ptr->m_remote_alive[remote])
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	record_t record = get_entity_record(decoder_ptr->m_remote_to_local[remote]);
+	if (!mask_has_component(record.m_archetype_ptr->m_component_mask, (component_index_t)component_index))
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	size_t component_size = archetype_get_column(record.m_archetype_ptr, (component_index_t)component_index).m_component_size;
+	if (offset > component_size || count > component_size - offset)
+		return TECS_RESULT_DELTA_STREAM_MALFORMED;
+
+	return read_bytes(stream, get_component_bytes(record.m_archetype_ptr, record.m_row, (component_index_t)component_index) + offset, (size_t)count);
+}
+
+tECS_result_t delta_decode_tick(delta_decoder_t *decoder_ptr, FILE *stream) {
+
+	int opcode = fgetc(stream);
+	if (opcode == EOF)
+		return ferror(stream) ? TECS_RESULT_DELTA_STREAM_IO_ERROR : TECS_RESULT_DELTA_STREAM_END;
+
+	while (opcode != DELTA_OP_END_TICK) {
+		tECS_result_t result;
+		switch (opcode) {
+			case DELTA_OP_DESTROY: result = decode_destroy(decoder_ptr, stream); break;
+			case DELTA_OP_CREATE: result = decode_create(decoder_ptr, stream, 0); break;
+			case DELTA_OP_MIGRATE: result = decode_create(decoder_ptr, stream, 1); break;
+			case DELTA_OP_UPDATE: result = decode_update(decoder_ptr, stream); break;
+			case EOF: result = TECS_RESULT_DELTA_STREAM_IO_ERROR; break;
+			default: result = TECS_RESULT_DELTA_STREAM_MALFORMED; break;
+		}
+		if (result != TECS_RESULT_SUCCESS)
+			return result;
+		opcode = fgetc(stream);
+	}
+
+	return TECS_RESULT_SUCCESS;
+}
+
+void free_delta_decoder(delta_decoder_t decoder) {
+	free(decoder.m_remote_alive);
+	free(decoder.m_remote_to_local);
+}
@@ -0,0 +1,81 @@
+#ifndef DELTA_H
+#define DELTA_H
+
+#include <stdio.h>
+
+#include "tecs_result.h"
+#include "entity.h"
+#include "archetype.h"
+#include "entity_manager.h"
+
+// A delta encoder remembers the state of every entity as of the last encoded tick, its baseline.
+// Each tick it writes only what changed since the baseline to a stream, then advances the baseline.
+typedef struct delta_encoder_t {
+
+	// Whether each entity was alive in the baseline. Indexed by entity.
+	unsigned char *m_baseline_alive;
+
+	// Component mask of each entity in the baseline. Indexed by entity.
+	component_mask_t *m_baseline_masks;
+
+	// Component bytes of each entity in the baseline, packed in component index order. Indexed by entity.
+	unsigned char **m_baseline_components;
+
+} delta_encoder_t;
+
+// Resolves a component mask to the local archetype in which entities with that signature are to be created.
+// Returns null if there is no such archetype.
+typedef archetype_t *(*delta_archetype_resolver_t)(component_mask_t component_mask, void *data_ptr);
+
+// A delta decoder applies a stream written by a delta encoder to the local entity manager.
+// Entities are created locally with whatever handle the entity manager provides, so the decoder maps the encoder's entities to local ones.
+typedef struct delta_decoder_t {
+
+	// Resolves component masks read from the stream to local archetypes.
+	delta_archetype_resolver_t m_resolver;
+
+	// Passed to the resolver on every call.
+	void *m_resolver_data_ptr;
+
+	// Whether each of the encoder's entities is currently mapped to a local entity. Indexed by the encoder's entity.
+	unsigned char *m_remote_alive;
+
+	// Maps the encoder's entities to local entities. Indexed by the encoder's entity.
+	entity_t *m_remote_to_local;
+
+} delta_decoder_t;
+
+// Creates a new delta encoder with an empty baseline, so that the first tick encodes every living entity as created.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails.
+tECS_result_t create_delta_encoder(delta_encoder_t *encoder_ptr);
+
+// Writes one tick to the stream: destroyed entities, then created entities, archetype migrations and changed component bytes, all relative to the baseline.
+// On success, the baseline then matches the current state.
+// An entity that was freed and whose handle was reused within the same tick is encoded as a migration or an update of that handle.
+// Returns TECS_RESULT_DELTA_STREAM_IO_ERROR if writing to the stream fails.
+// Returns TECS_RESULT_BAD_ALLOC if the baseline cannot be grown.
+// The baseline is advanced as each operation is encoded, so after any result other than TECS_RESULT_SUCCESS the baseline may hold changes the stream never received, and part of the tick may already have been written.
+// Retrying is therefore not possible: the encoder and the stream must both be recreated, and the decoder must start over from a fresh world.
+tECS_result_t delta_encode_tick(delta_encoder_t *encoder_ptr, FILE *stream);
+
+// Destroys the delta encoder, freeing its baseline.
+void free_delta_encoder(delta_encoder_t encoder);
+
+// Creates a new delta decoder that resolves archetypes with the given resolver.
+// Returns TECS_RESULT_BAD_ALLOC if allocation fails.
+tECS_result_t create_delta_decoder(delta_archetype_resolver_t resolver, void *resolver_data_ptr, delta_decoder_t *decoder_ptr);
+
+// Reads one tick from the stream and applies it to the local entity manager.
+// Returns TECS_RESULT_DELTA_STREAM_END if the stream ended cleanly before the tick.
+// Returns TECS_RESULT_DELTA_STREAM_IO_ERROR if reading from the stream fails or it ends mid-tick.
+// Returns TECS_RESULT_DELTA_STREAM_MALFORMED if the tick does not match the local component registry or entity state.
+// Returns TECS_RESULT_DELTA_ARCHETYPE_NOT_FOUND if the resolver returns null.
+// Any error from create_entity or free_entity is returned as-is.
+// Operations are applied as they are read, so after any result other than TECS_RESULT_SUCCESS or TECS_RESULT_DELTA_STREAM_END the tick is partly applied: entities may already have been created or freed, and a migrating entity may have been freed without being recreated.
+// The local world is then inconsistent with the encoder, and must be discarded along with the decoder.
+tECS_result_t delta_decode_tick(delta_decoder_t *decoder_ptr, FILE *stream);
+
+// Destroys the delta decoder. Local entities created by the decoder are not freed.
+void free_delta_decoder(delta_decoder_t decoder);
+
+#endif	// DELTA_H
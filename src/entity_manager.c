@@ -39,12 +39,8 @@ tECS_result_t create_entity(archetype_t *archetype_ptr, entity_t *entity_ptr) {
 	if (num_allocated_entities >= MAX_NUM_ENTITIES)
 		return TECS_RESULT_NO_ENTITIES_AVAILABLE;
 
-	// Swap the entity at the back with the first available entity.
-	entity_t swap = entities[num_allocated_entities];	// This is the first available entity and it will be returned.
-	entities[num_allocated_entities] = entities[MAX_NUM_ENTITIES - 1]; // Put the back entity where the gotten entity is, which will be the last unavailable position.
-	entity_positions[entities[MAX_NUM_ENTITIES - 1]] = num_allocated_entities;	// The back entity's new position is at num_allocated_entities. 
-	entities[MAX_NUM_ENTITIES - 1] = swap;	// Put the gotten entity at the back.
-	entity_positions[swap] = MAX_NUM_ENTITIES - 1;	// The gotten entity's new position is at the back.
+	// Take the first available entity. It already sits at the partition, so advancing the partition past it marks it unavailable without moving any entity.
+	entity_t swap = entities[num_allocated_entities];
 	num_allocated_entities++;
 
 	// Create a new record for this entity.
@@ -75,7 +71,7 @@ tECS_result_t free_entity(entity_t entity) {
 	size_t row = entity_records[entity].m_row;
 	archetype_remove_row(archetype_ptr, row);
 	// If a middle row was removed, then the back row was moved into its spot, and the corresponding record must be updated to reflect that.
-	if (row == archetype_ptr->m_num_used_rows)
+	if (row < archetype_ptr->m_num_used_rows)
 		entity_records[archetype_ptr->m_rows_to_entities[row]].m_row = row;
 	entity_records[entity].m_archetype_ptr = NULL;
 	entity_records[entity].m_row = 0;
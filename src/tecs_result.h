@@ -8,7 +8,11 @@ typedef enum tECS_result_t {
 	TECS_RESULT_NO_ENTITIES_AVAILABLE,
 	TECS_RESULT_INVALID_ENTITY_ID,
 	TECS_RESULT_ENTITY_ALREADY_FREE,
-	TECS_RESULT_COMPONENT_TABLE_ROW_REMOVE_OUT_OF_BOUNDS
+	TECS_RESULT_COMPONENT_TABLE_ROW_REMOVE_OUT_OF_BOUNDS,
+	TECS_RESULT_DELTA_STREAM_END,
+	TECS_RESULT_DELTA_STREAM_IO_ERROR,
+	TECS_RESULT_DELTA_STREAM_MALFORMED,
+	TECS_RESULT_DELTA_ARCHETYPE_NOT_FOUND
 } tECS_result_t;
 
 #endif // TECS_RESULT_H